@@ -2,7 +2,7 @@ from esphome import pins
 import esphome.codegen as cg
 from esphome.components import i2c
 import esphome.config_validation as cv
-from esphome.const import CONF_ID, CONF_RESET_PIN
+from esphome.const import CONF_DURATION, CONF_ID, CONF_RESET_PIN
 
 CONF_TOUCH_THRESHOLD = "touch_threshold"
 CONF_ALLOW_MULTIPLE_TOUCHES = "allow_multiple_touches"
@@ -11,6 +11,8 @@ CONF_BRIGHTNESS_CONFIGS = "brightness_configs"
 CONF_LED_BEHAVIOR = "led_behavior"
 CONF_MAX_BRIGHTNESS = "max_brightness"
 CONF_MIN_BRIGHTNESS = "min_brightness"
+CONF_CALIBRATION = "calibration"
+CONF_SAVE_TO_FLASH = "save_to_flash"
 
 DEPENDENCIES = ["i2c"]
 AUTO_LOAD = ["binary_sensor", "output"]
@@ -36,6 +38,15 @@ BRIGHTNESS_CONFIG_SCHEMA = cv.Schema({
     cv.Optional(CONF_MIN_BRIGHTNESS, default=0.0): cv.percentage,    # 0-100%
 })
 
+# Schema for automatic per-channel threshold calibration
+CALIBRATION_SCHEMA = cv.Schema({
+    cv.Optional(CONF_DURATION, default="30s"): cv.All(
+        cv.positive_time_period_milliseconds,
+        cv.Range(min=cv.TimePeriod(seconds=1)),
+    ),
+    cv.Optional(CONF_SAVE_TO_FLASH, default=True): cv.boolean,
+})
+
 def validate_brightness_config(config):
     """Validate that max_brightness >= min_brightness for each behavior config."""    
     for brightness_config in config.get(CONF_BRIGHTNESS_CONFIGS, []):
@@ -65,6 +76,7 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_BRIGHTNESS_CONFIGS, default=[]): cv.ensure_list(
                 BRIGHTNESS_CONFIG_SCHEMA
             ),
+            cv.Optional(CONF_CALIBRATION): CALIBRATION_SCHEMA,
         }
     )
     .extend(cv.COMPONENT_SCHEMA)
@@ -83,6 +95,11 @@ async def to_code(config):
         pin = await cg.gpio_pin_expression(reset_pin_config)
         cg.add(var.set_reset_pin(pin))
 
+    if calibration_config := config.get(CONF_CALIBRATION):
+        cg.add(var.set_calibration_enabled(True))
+        cg.add(var.set_calibration_duration(calibration_config[CONF_DURATION]))
+        cg.add(var.set_calibration_save_to_flash(calibration_config[CONF_SAVE_TO_FLASH]))
+
     # Configure brightness settings per behavior
     # Convert percentages (0.0-1.0) to actual percentages (0-100)
     for brightness_config in config.get(CONF_BRIGHTNESS_CONFIGS, []):
@@ -1,6 +1,12 @@
 #include "cap1166.h"
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <string>
 
 namespace esphome {
 namespace cap1166 {
@@ -10,6 +16,12 @@ static const char *const TAG = "cap1166";
 const CAP1166LedBehavior behaviors[] = {
   LED_BEHAVIOR_DIRECT, LED_BEHAVIOR_PULSE1, LED_BEHAVIOR_PULSE2, LED_BEHAVIOR_BREATHE
 };
+// Minimum gap (in delta counts) between noise and touch peak for a channel to count as touched
+static const uint8_t CAP1166_CALIBRATION_MIN_SIGNAL = 8;
+// A touch peak must also reach 1/CAP1166_CALIBRATION_MIN_PEAK_DIVIDER of the current threshold,
+// so drift or crosstalk on a skipped pad does not lower its threshold
+static const uint8_t CAP1166_CALIBRATION_MIN_PEAK_DIVIDER = 4;
+static const uint8_t CAP1166_THRESHOLD_MAX = 0x7F;
 
 void CAP1166Component::setup() {
   this->disable_loop();
@@ -53,6 +65,28 @@ void CAP1166Component::finish_setup_() {
   sensitivity = sensitivity & 0x0f;
   this->write_byte(CAP1166_SENSITIVITY, sensitivity | this->touch_threshold_);
 
+  if (this->calibration_enabled_) {
+    CAP1166CalibrationData data{};
+    if (this->calibration_save_to_flash_) {
+      // touch_threshold sets the delta count scale, so a config change must not restore old thresholds
+      std::string key = str_sprintf("cap1166_calibration_%02x_%02x", this->address_, this->touch_threshold_);
+      this->calibration_pref_ = global_preferences->make_preference<CAP1166CalibrationData>(fnv1_hash(key), true);
+    }
+    if (this->calibration_save_to_flash_ && this->calibration_pref_.load(&data) &&
+        std::all_of(std::begin(data.thresholds), std::end(data.thresholds),
+                    [](uint8_t t) { return t > 0 && t <= CAP1166_THRESHOLD_MAX; })) {
+      memcpy(this->channel_thresholds_, data.thresholds, CAP1166_CHANNEL_COUNT);
+      if (this->write_thresholds_()) {
+        ESP_LOGI(TAG, "Restored channel thresholds from flash");
+        for (uint8_t i = 0; i < CAP1166_CHANNEL_COUNT; i++) {
+          ESP_LOGD(TAG, "Channel %u threshold: 0x%02x", i, this->channel_thresholds_[i]);
+        }
+      }
+    } else {
+      this->start_calibration();
+    }
+  }
+
   // Allow multiple touches
   this->write_byte(CAP1166_MULTI_TOUCH, this->allow_multiple_touches_);
 
@@ -89,6 +123,12 @@ void CAP1166Component::dump_config() {
                 "  Manufacture ID: 0x%x\n"
                 "  Revision ID: 0x%x",
                 this->cap1166_product_id_, this->cap1166_manufacture_id_, this->cap1166_revision_);
+  if (this->calibration_enabled_) {
+    ESP_LOGCONFIG(TAG,
+                  "  Calibration duration: %" PRIu32 "ms\n"
+                  "  Calibration saved to flash: %s",
+                  this->calibration_duration_, YESNO(this->calibration_save_to_flash_));
+  }
 
   switch (this->error_code_) {
     case COMMUNICATION_FAILED:
@@ -113,6 +153,10 @@ void CAP1166Component::loop() {
     this->write_byte(CAP1166_MAIN, data);
   }
 
+  if (this->calibrating_) {
+    this->calibration_sample_(touched);
+  }
+
   for (auto *channel : this->channels_) {
     channel->process(touched);
   }
@@ -218,6 +262,132 @@ void CAP1166Component::set_behavior_brightness(CAP1166LedBehavior behavior,
            behavior, max_brightness_percent, max_reg_value, min_brightness_percent, min_reg_value);
 }
 
+void CAP1166Component::start_calibration() {
+  if (this->is_failed()) {
+    return;
+  }
+
+  // Current thresholds are kept for channels that never see a touch
+  if (this->read_register(CAP1166_SENSOR_THRESHOLD, this->channel_thresholds_, CAP1166_CHANNEL_COUNT) !=
+      i2c::ERROR_OK) {
+    ESP_LOGW(TAG, "Failed to read channel thresholds, calibration aborted");
+    return;
+  }
+  memset(this->noise_max_, 0, sizeof(this->noise_max_));
+  memset(this->peak_, 0, sizeof(this->peak_));
+  this->calibration_samples_ = 0;
+  this->calibrating_ = true;
+  this->calibration_idle_ = true;
+
+  uint32_t idle_duration = this->calibration_duration_ / 4;
+  ESP_LOGI(TAG, "Calibrating for %" PRIu32 "ms, leave the pads alone for %" PRIu32 "ms then touch each pad a few times",
+           this->calibration_duration_, idle_duration);
+  this->set_timeout("calibration_idle", idle_duration, [this]() {
+    this->calibration_idle_ = false;
+    ESP_LOGI(TAG, "Noise sampled, touch each pad a few times");
+  });
+  this->set_timeout("calibration", this->calibration_duration_, [this]() { this->finish_calibration_(); });
+}
+
+void CAP1166Component::calibration_sample_(uint8_t touched) {
+  uint8_t deltas[CAP1166_CHANNEL_COUNT];
+  // One burst read covers all delta count registers
+  if (this->read_register(CAP1166_SENSOR_DELTA_COUNT, deltas, CAP1166_CHANNEL_COUNT) != i2c::ERROR_OK) {
+    return;
+  }
+  this->calibration_samples_++;
+
+  for (uint8_t i = 0; i < CAP1166_CHANNEL_COUNT; i++) {
+    // Delta counts are two's complement; negative values are below the base count and never a touch
+    int8_t delta = static_cast<int8_t>(deltas[i]);
+
+    if (this->calibration_idle_) {
+      // Pads should be left alone in the idle window; skip samples the chip still reports as touched
+      uint8_t magnitude = delta < 0 ? -delta : delta;
+      if (!(touched & (1 << i)) && magnitude > this->noise_max_[i]) {
+        this->noise_max_[i] = magnitude;
+      }
+    } else if (delta > 0 && delta > this->peak_[i]) {
+      this->peak_[i] = delta;
+    }
+  }
+}
+
+bool CAP1166Component::calculate_threshold_(uint8_t channel, uint8_t *threshold) {
+  uint8_t current = this->channel_thresholds_[channel];
+  uint8_t noise = this->noise_max_[channel];
+  uint8_t peak = this->peak_[channel];
+
+  if (peak < noise + CAP1166_CALIBRATION_MIN_SIGNAL || peak < current / CAP1166_CALIBRATION_MIN_PEAK_DIVIDER) {
+    // No clear touch - keep the current threshold, only ever raised above the noise
+    ESP_LOGD(TAG, "No touch detected on channel %u during calibration (noise %u, peak %u)", channel, noise, peak);
+    uint16_t noise_ceiling = noise + CAP1166_CALIBRATION_MIN_SIGNAL;
+    *threshold = std::min<uint16_t>(std::max<uint16_t>(current, noise_ceiling), CAP1166_THRESHOLD_MAX);
+    return false;
+  }
+
+  // Halfway between the noise ceiling and the touch peak, so always above the noise and below the peak
+  uint8_t tuned = noise + (peak - noise) / 2;
+  *threshold = std::max<uint8_t>(1, std::min<uint8_t>(tuned, CAP1166_THRESHOLD_MAX));
+  return true;
+}
+
+void CAP1166Component::finish_calibration_() {
+  this->calibrating_ = false;
+
+  if (this->calibration_samples_ == 0) {
+    ESP_LOGW(TAG, "Calibration collected no samples, keeping current thresholds");
+    return;
+  }
+
+  uint8_t calibrated = 0;
+  for (uint8_t i = 0; i < CAP1166_CHANNEL_COUNT; i++) {
+    if (this->calculate_threshold_(i, &this->channel_thresholds_[i])) {
+      calibrated++;
+    }
+    ESP_LOGD(TAG, "Channel %u: noise %u, peak %u -> threshold 0x%02x", i, this->noise_max_[i], this->peak_[i],
+             this->channel_thresholds_[i]);
+  }
+  if (!this->write_thresholds_()) {
+    return;
+  }
+
+  if (calibrated == 0) {
+    // Likely an unattended boot; don't save so calibration runs again next time
+    ESP_LOGW(TAG, "Calibration finished but no pad was touched, thresholds not saved");
+    return;
+  }
+
+  if (this->calibration_save_to_flash_) {
+    CAP1166CalibrationData data{};
+    memcpy(data.thresholds, this->channel_thresholds_, CAP1166_CHANNEL_COUNT);
+    if (!this->calibration_pref_.save(&data)) {
+      ESP_LOGW(TAG, "Failed to save channel thresholds to flash");
+    }
+  }
+
+  ESP_LOGI(TAG, "Calibration finished after %" PRIu32 " samples, %u of %u channels touched",
+           this->calibration_samples_, calibrated, CAP1166_CHANNEL_COUNT);
+}
+
+bool CAP1166Component::write_thresholds_() {
+  // Clear BUT_LD_TH so the input 1 threshold is not copied to every input
+  uint8_t recalibration = 0;
+  if (!this->read_byte(CAP1166_RECALIBRATION_CONFIGURATION, &recalibration)) {
+    ESP_LOGW(TAG, "Failed to read recalibration configuration, channel thresholds not written");
+    return false;
+  }
+  this->write_byte(CAP1166_RECALIBRATION_CONFIGURATION, recalibration & 0x7F);
+
+  // Threshold registers are consecutive, so one block write sets all channels
+  if (this->write_register(CAP1166_SENSOR_THRESHOLD, this->channel_thresholds_, CAP1166_CHANNEL_COUNT) !=
+      i2c::ERROR_OK) {
+    ESP_LOGW(TAG, "Failed to write channel thresholds");
+    return false;
+  }
+  return true;
+}
+
 uint8_t CAP1166Component::percentage_to_register_value_(uint8_t percentage) {
   // Max brightness mapping: 7% to 100% -> register values 0x0 to 0xF
   // Min brightness mapping: 0% to 77% -> register values 0x0 to 0xF
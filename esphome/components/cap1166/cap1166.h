@@ -2,6 +2,7 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/preferences.h"
 #include "esphome/components/i2c/i2c.h"
 #include "esphome/components/output/binary_output.h"
 #include "esphome/components/binary_sensor/binary_sensor.h"
@@ -15,6 +16,7 @@ namespace cap1166 {
 enum {
   CAP1166_I2CADDR = 0x29,
   CAP1166_SENSOR_INPUT_STATUS = 0x3,
+  CAP1166_SENSOR_DELTA_COUNT = 0x10, //Delta counts for inputs 1-6 (0x10-0x15), signed 8-bit
   CAP1166_MULTI_TOUCH = 0x2A,
   CAP1166_LED_LINK = 0x72,
   CAP1166_PRODUCT_ID = 0xFD,
@@ -25,6 +27,8 @@ enum {
   CAP1166_MAIN_INT = 0x01,
   CAP1166_INTERUPT_REPEAT = 0x28,
   CAP1166_SENSITIVITY = 0x1f,
+  CAP1166_RECALIBRATION_CONFIGURATION = 0x2F, //Bit 7 (BUT_LD_TH) - writing input 1 threshold updates all inputs
+  CAP1166_SENSOR_THRESHOLD = 0x30, //Touch thresholds for inputs 1-6 (0x30-0x35), 7-bit
   CAP1166_LEDPOL = 0x73,
   CAP1166_LED_OUT = 0x74, //The LED Output Control Register controls the output state of the LED pins that are not linked to sensor inputs
   CAP1166_LED_BEHAVIOUR1 = 0x81, //LEDs 1-4; Each led has 2 bits defining behaviour: 
@@ -40,6 +44,8 @@ enum {
   CAP1166_LED_DUTY_DIRECT = 0x93,
 };
 
+static const uint8_t CAP1166_CHANNEL_COUNT = 6;
+
 // LED behavior enumeration
 enum CAP1166LedBehavior {
   LED_BEHAVIOR_DIRECT = 0x00,   // 00 - direct
@@ -48,6 +54,11 @@ enum CAP1166LedBehavior {
   LED_BEHAVIOR_BREATHE = 0x03,  // 11 - breathe
 };
 
+// Per-channel thresholds persisted to flash after calibration
+struct CAP1166CalibrationData {
+  uint8_t thresholds[CAP1166_CHANNEL_COUNT];
+} __attribute__((packed));
+
 class CAP1166Channel {
  public:
   virtual void process(uint8_t data) = 0;
@@ -75,6 +86,9 @@ class CAP1166Component : public Component, public i2c::I2CDevice {
   };
 
   void set_reset_pin(GPIOPin *reset_pin) { this->reset_pin_ = reset_pin; }
+  void set_calibration_enabled(bool calibration_enabled) { this->calibration_enabled_ = calibration_enabled; }
+  void set_calibration_duration(uint32_t calibration_duration) { this->calibration_duration_ = calibration_duration; }
+  void set_calibration_save_to_flash(bool save_to_flash) { this->calibration_save_to_flash_ = save_to_flash; }
   void setup() override;
   void dump_config() override;
   void loop() override;
@@ -86,6 +100,9 @@ class CAP1166Component : public Component, public i2c::I2CDevice {
                               uint8_t max_brightness_percentage,
                               uint8_t min_brightness_percentage);
   void update_all_brightness(uint8_t min_brightness, uint8_t max_brightness);
+  // Sample delta counts for the configured duration and write tuned per-channel thresholds.
+  // Leave the pads alone for the first quarter (noise), then touch every pad a few times.
+  void start_calibration();
 
  protected:
   void finish_setup_();
@@ -93,6 +110,10 @@ class CAP1166Component : public Component, public i2c::I2CDevice {
   static uint8_t percentage_to_min_register_value_(uint8_t percentage);
   static uint8_t percentage_to_register_value_(uint8_t percentage);
   void reconfigure_all_led_brightness();
+  void calibration_sample_(uint8_t touched);
+  void finish_calibration_();
+  bool calculate_threshold_(uint8_t channel, uint8_t *threshold);
+  bool write_thresholds_();
 
   std::vector<CAP1166Channel *> channels_{};
   std::vector<CAP1166LedChannel *> led_channels_{};
@@ -102,6 +123,21 @@ class CAP1166Component : public Component, public i2c::I2CDevice {
   uint8_t allow_multiple_touches_{0x80};
   uint8_t link_leds_{0xFF};
 
+  bool calibration_enabled_{false};
+  bool calibration_save_to_flash_{false};
+  bool calibrating_{false};
+  bool calibration_idle_{false};
+  uint32_t calibration_duration_{30000};
+  uint32_t calibration_samples_{0};
+  ESPPreferenceObject calibration_pref_;
+
+  // Chip defaults to 0x40 for every input
+  uint8_t channel_thresholds_[CAP1166_CHANNEL_COUNT]{0x40, 0x40, 0x40, 0x40, 0x40, 0x40};
+  // Largest delta count seen per channel in the idle window at the start of calibration
+  uint8_t noise_max_[CAP1166_CHANNEL_COUNT]{};
+  // Largest delta count seen per channel after the idle window
+  uint8_t peak_[CAP1166_CHANNEL_COUNT]{};
+
   uint8_t behavior_max_brightness_[4]{0xF, 0xF, 0xF, 0xF};
   uint8_t behavior_min_brightness_[4]{0x0, 0x0, 0x0, 0x0};
 